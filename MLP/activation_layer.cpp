@@ -16,7 +16,42 @@ Eigen::VectorXd ActivationLayer::compute(const Eigen::VectorXd &x) {
   return {};
 }
 
+Eigen::MatrixXd
+ActivationLayer::computeBatch(Eigen::Ref<const Eigen::MatrixXd> X) {
+  if (_type == enActiveFuncType::enSoftMax) {
+    Eigen::MatrixXd Y =
+        (X.rowwise() - X.colwise().maxCoeff()).array().exp().matrix();
+    Y.array().rowwise() /= Y.colwise().sum().array();
+    return Y;
+  } else if (_type == enActiveFuncType::enReLU) {
+    return X.cwiseMax(0.0);
+  }
+  return {};
+}
+
+Eigen::MatrixXd ActivationLayer::backward(const Eigen::MatrixXd &X,
+                                          const Eigen::MatrixXd &Y,
+                                          const Eigen::MatrixXd &dY,
+                                          LayerGradient &grad,
+                                          bool need_dX) const {
+  (void)grad;
+  if (!need_dX) {
+    return {};
+  }
+  if (_type == enActiveFuncType::enSoftMax) {
+    Eigen::RowVectorXd dot = (dY.array() * Y.array()).colwise().sum();
+    return (Y.array() * (dY.rowwise() - dot).array()).matrix();
+  } else if (_type == enActiveFuncType::enReLU) {
+    return (X.array() > 0.0).select(dY.array(), 0.0).matrix();
+  }
+  return {};
+}
+
 Eigen::VectorXd ActivationLayer::soft_max(const Eigen::VectorXd &x) {
+  // 空向量没有最大值，直接返回
+  if (x.size() == 0) {
+    return {};
+  }
   Eigen::VectorXd exp_x = (x.array() - x.maxCoeff()).exp();
   return exp_x / exp_x.sum();
 }
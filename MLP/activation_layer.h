@@ -10,8 +10,21 @@ public:
   };
   int inputDim() const override { return _input_dimension; }
   int outputDim() const override { return _output_dimension; }
+  std::unique_ptr<Layer> clone() const override {
+    return std::make_unique<ActivationLayer>(*this);
+  }
   ActivationLayer(enActiveFuncType type, int inputDim, int outputDim);
   Eigen::VectorXd compute(const Eigen::VectorXd &x) override;
+  Eigen::MatrixXd computeBatch(Eigen::Ref<const Eigen::MatrixXd> X) override;
+  /**
+   * @brief 批量反向传播
+   * ReLU: dX = dY ⊙ (X > 0)
+   * Softmax（逐列）: dX = Y ⊙ (dY - <dY, Y>)
+   */
+  Eigen::MatrixXd backward(const Eigen::MatrixXd &X, const Eigen::MatrixXd &Y,
+                           const Eigen::MatrixXd &dY, LayerGradient &grad,
+                           bool need_dX) const override;
+  enActiveFuncType type() const { return _type; }
   static void test();
   static Eigen::VectorXd soft_max(const Eigen::VectorXd &x);
   static Eigen::VectorXd relu(const Eigen::VectorXd &x);
@@ -0,0 +1,96 @@
+// 对比各 GEMM 后端在 MNIST MLP 各层形状上的性能
+// 用法: MLP_gemm_bench [batch ...]，默认 batch = 1 64 256
+#include "dense_layer.h"
+#include "gemm_backend.h"
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+struct Shape {
+  int in;
+  int out;
+};
+
+// 运行至少 min_seconds，返回单次耗时（秒）
+template <typename Fn> double time_it(Fn &&fn, double min_seconds = 0.2) {
+  fn(); // 预热
+  int iters = 1;
+  while (true) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; ++i) {
+      fn();
+    }
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    if (seconds >= min_seconds) {
+      return seconds / iters;
+    }
+    iters *= 2;
+  }
+}
+// 整个字符串都是正整数时返回 true
+bool parse_positive_int(const char *text, int &value) {
+  const char *end = text + std::strlen(text);
+  auto [ptr, ec] = std::from_chars(text, end, value);
+  return ec == std::errc() && ptr == end && value > 0;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  std::vector<int> batches;
+  for (int i = 1; i < argc; ++i) {
+    int batch = 0;
+    if (!parse_positive_int(argv[i], batch)) {
+      std::fprintf(stderr,
+                   "usage: %s [batch ...]\n"
+                   "  batch: positive integer, default 1 64 256\n",
+                   argv[0]);
+      return 1;
+    }
+    batches.push_back(batch);
+  }
+  if (batches.empty()) {
+    batches = {1, 64, 256};
+  }
+
+  const std::vector<Shape> shapes = {{784, 256}, {256, 128}, {128, 10}};
+  const auto reference = GemmBackend::create("naive");
+  std::mt19937 rng(42);
+
+  for (const std::string &name : GemmBackend::available()) {
+    const int threads = GemmBackend::create(name)->threadCount();
+    std::printf("%s threads: %s\n", name.c_str(),
+                threads < 0 ? "unknown" : std::to_string(threads).c_str());
+  }
+  std::printf("%-8s %-12s %6s %12s %10s %12s\n", "backend", "layer", "batch",
+              "time(us)", "GFLOP/s", "max|diff|");
+  for (const Shape &shape : shapes) {
+    DenseLayer layer(shape.in, shape.out);
+    layer.initRandom(rng);
+    for (int batch : batches) {
+      Eigen::MatrixXd X = Eigen::MatrixXd::Random(shape.in, batch);
+      layer.setBackend(reference);
+      Eigen::MatrixXd expected = layer.computeBatch(X);
+
+      for (const std::string &name : GemmBackend::available()) {
+        layer.setBackend(GemmBackend::create(name));
+        Eigen::MatrixXd Y;
+        double seconds = time_it([&] { Y = layer.computeBatch(X); });
+        double gflops = 2.0 * shape.in * shape.out * batch / seconds * 1e-9;
+        std::string label =
+            std::to_string(shape.in) + "x" + std::to_string(shape.out);
+        std::printf("%-8s %-12s %6d %12.2f %10.2f %12.2e\n", name.c_str(),
+                    label.c_str(), batch, seconds * 1e6, gflops,
+                    (Y - expected).cwiseAbs().maxCoeff());
+      }
+    }
+  }
+  return 0;
+}
@@ -1,8 +1,10 @@
 #include "dataset.h"
 #include <Eigen/Dense>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -182,6 +184,77 @@ void DataSet::load_data_set(const std::string &imageFloder,
   }
 }
 
+namespace {
+// IDX 文件头是大端 32 位整数
+int read_be_int32(std::ifstream &in) {
+  unsigned char buf[4];
+  if (!in.read(reinterpret_cast<char *>(buf), 4)) {
+    throw std::runtime_error("Unexpected end of IDX file");
+  }
+  const uint32_t value = (uint32_t(buf[0]) << 24) | (uint32_t(buf[1]) << 16) |
+                         (uint32_t(buf[2]) << 8) | uint32_t(buf[3]);
+  return static_cast<int>(value);
+}
+} // namespace
+
+void DataSet::load_mnist_idx(const std::string &imagesFile,
+                             const std::string &labelsFile) {
+  std::ifstream images(imagesFile, std::ios::binary);
+  if (!images.is_open()) {
+    throw std::runtime_error("Failed to open file: " + imagesFile);
+  }
+  std::ifstream labels(labelsFile, std::ios::binary);
+  if (!labels.is_open()) {
+    throw std::runtime_error("Failed to open file: " + labelsFile);
+  }
+
+  if (read_be_int32(images) != 2051) {
+    throw std::runtime_error("Invalid IDX image file: " + imagesFile);
+  }
+  if (read_be_int32(labels) != 2049) {
+    throw std::runtime_error("Invalid IDX label file: " + labelsFile);
+  }
+  const int count = read_be_int32(images);
+  const int rows = read_be_int32(images);
+  const int cols = read_be_int32(images);
+  if (read_be_int32(labels) != count) {
+    throw std::runtime_error("IDX image/label count mismatch");
+  }
+  if (count <= 0 || rows <= 0 || cols <= 0) {
+    throw std::runtime_error("Invalid IDX header: " + imagesFile);
+  }
+  // 头部声明的大小必须与文件实际大小相符，防止溢出或截断的文件
+  const uint64_t pixels64 = uint64_t(rows) * uint64_t(cols);
+  if (pixels64 > uint64_t(std::numeric_limits<int>::max()) ||
+      std::filesystem::file_size(imagesFile) < 16 + pixels64 * count) {
+    throw std::runtime_error("Invalid IDX image file: " + imagesFile);
+  }
+  if (std::filesystem::file_size(labelsFile) < 8 + uint64_t(count)) {
+    throw std::runtime_error("Invalid IDX label file: " + labelsFile);
+  }
+
+  // 与 prepare_input 相同：[0,1] 后按 PyTorch Normalize((0.1307,), (0.3081,))
+  const double mean = 0.1307;
+  const double stdv = 0.3081;
+  const int pixels = static_cast<int>(pixels64);
+  std::vector<unsigned char> image(pixels);
+  _dataSet.reserve(_dataSet.size() + count);
+  for (int i = 0; i < count; ++i) {
+    char lab = 0;
+    if (!images.read(reinterpret_cast<char *>(image.data()), pixels) ||
+        !labels.read(&lab, 1)) {
+      throw std::runtime_error("Unexpected end of IDX file");
+    }
+    MNISetData data;
+    data.data.resize(pixels);
+    for (int p = 0; p < pixels; ++p) {
+      data.data[p] = (image[p] / 255.0 - mean) / stdv;
+    }
+    data.lab = static_cast<unsigned char>(lab);
+    _dataSet.push_back(std::move(data));
+  }
+}
+
 std::vector<std::pair<int, int>>
 DataSet::load_labs_from_txt(const std::string &file_path) {
   std::vector<std::pair<int, int>> result;
@@ -30,7 +30,15 @@ public:
 
   void load_data_set(const std::string &imageFloder,
                      const std::string &labsText);
-  std::vector<MNISetData> getDataSet() { return _dataSet; }
+  /**
+   * @brief 直接读取 MNIST 原始 IDX 文件（未压缩），预处理与 prepare_input 一致
+   * @param imagesFile 如 train-images-idx3-ubyte
+   * @param labelsFile 如 train-labels-idx1-ubyte
+   * @throws std::runtime_error 如果文件无法打开或格式错误
+   */
+  void load_mnist_idx(const std::string &imagesFile,
+                      const std::string &labelsFile);
+  const std::vector<MNISetData> &getDataSet() const { return _dataSet; }
 
 private:
   std::vector<std::pair<int, int>>
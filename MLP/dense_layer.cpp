@@ -1,10 +1,12 @@
 #include "dense_layer.h"
 #include <Eigen/src/Core/Matrix.h>
+#include <cmath>
 DenseLayer::DenseLayer(int input_dim, int output_dim)
     : _input_dimension(input_dim), _output_dimension(output_dim),
       W(Eigen::MatrixXd::Zero(
           output_dim, input_dim)),
-      b(Eigen::VectorXd::Zero(output_dim)) {
+      b(Eigen::VectorXd::Zero(output_dim)),
+      _backend(GemmBackend::defaultBackend()) {
 
   // 参数验证
   if (input_dim <= 0 || output_dim <= 0) {
@@ -28,6 +30,13 @@ void DenseLayer::setB(const Eigen::VectorXd &b) {
   this->b = b;
 }
 
+void DenseLayer::setBackend(std::shared_ptr<const GemmBackend> backend) {
+  if (backend == nullptr) {
+    throw std::invalid_argument("GEMM 后端不能为空");
+  }
+  _backend = std::move(backend);
+}
+
 Eigen::VectorXd DenseLayer::compute(const Eigen::VectorXd &x) {
   // 输入维度检查
   if (x.size() != _input_dimension) {
@@ -35,5 +44,67 @@ Eigen::VectorXd DenseLayer::compute(const Eigen::VectorXd &x) {
   }
 
   // 计算并返回结果
-  return W * x + b;
+  Eigen::VectorXd y = b;
+  _backend->gemm(false, false, 1.0, W, x, 1.0, y);
+  return y;
+}
+
+Eigen::MatrixXd
+DenseLayer::computeBatch(Eigen::Ref<const Eigen::MatrixXd> X) {
+  if (X.rows() != _input_dimension) {
+    throw std::invalid_argument("输入矩阵维度不匹配");
+  }
+  Eigen::MatrixXd Y = b.replicate(1, X.cols());
+  _backend->gemm(false, false, 1.0, W, X, 1.0, Y);
+  return Y;
+}
+
+Eigen::MatrixXd DenseLayer::backward(const Eigen::MatrixXd &X,
+                                     const Eigen::MatrixXd &Y,
+                                     const Eigen::MatrixXd &dY,
+                                     LayerGradient &grad, bool need_dX) const {
+  (void)Y;
+  if (X.rows() != _input_dimension || dY.rows() != _output_dimension ||
+      X.cols() != dY.cols()) {
+    throw std::invalid_argument("反向传播矩阵维度不匹配");
+  }
+  if (grad.dW.rows() != _output_dimension ||
+      grad.dW.cols() != _input_dimension) {
+    throw std::invalid_argument("梯度累加器未初始化");
+  }
+
+  _backend->gemm(false, true, 1.0, dY, X, 1.0, grad.dW);
+  grad.db += dY.rowwise().sum();
+  if (!need_dX) {
+    return {};
+  }
+  Eigen::MatrixXd dX(_input_dimension, dY.cols());
+  _backend->gemm(true, false, 1.0, W, dY, 0.0, dX);
+  return dX;
+}
+
+void DenseLayer::initGradient(LayerGradient &grad) const {
+  grad.dW = Eigen::MatrixXd::Zero(_output_dimension, _input_dimension);
+  grad.db = Eigen::VectorXd::Zero(_output_dimension);
+}
+
+void DenseLayer::applyStep(const LayerGradient &step) {
+  if (step.dW.rows() != _output_dimension ||
+      step.dW.cols() != _input_dimension ||
+      step.db.size() != _output_dimension) {
+    throw std::invalid_argument("更新步长维度不匹配");
+  }
+  W -= step.dW;
+  b -= step.db;
+}
+
+void DenseLayer::initRandom(std::mt19937 &rng) {
+  const double bound = 1.0 / std::sqrt(static_cast<double>(_input_dimension));
+  std::uniform_real_distribution<double> dist(-bound, bound);
+  for (Eigen::Index i = 0; i < W.size(); ++i) {
+    W.data()[i] = dist(rng);
+  }
+  for (Eigen::Index i = 0; i < b.size(); ++i) {
+    b[i] = dist(rng);
+  }
 }
\ No newline at end of file
@@ -3,12 +3,15 @@
 #include <Eigen/Dense>
 #include <Eigen/src/Core/Matrix.h>
 #include <iostream>
+#include <random>
 
+#include "gemm_backend.h"
 #include "layer.h"
 
 ///* `output = W * input + b`
 ///* `W` 是[输出维度 × 输入维度] 矩阵
 // * `b` 是[输出维度] 向量
+// * 矩阵乘法由 GemmBackend 完成，默认 GemmBackend::defaultBackend()
 class DenseLayer : public Layer {
 public:
   DenseLayer(int input_dim, int output_dim);
@@ -17,8 +20,14 @@ public:
   void setB(const Eigen::VectorXd &b);
   const Eigen::MatrixXd &getW() const { return W; }
   const Eigen::VectorXd &getB() const { return b; }
+  /// @throws std::invalid_argument 如果 backend 为空
+  void setBackend(std::shared_ptr<const GemmBackend> backend);
+  const GemmBackend &backend() const { return *_backend; }
   int inputDim() const override{ return _input_dimension; }
   int outputDim() const override{ return _output_dimension; }
+  std::unique_ptr<Layer> clone() const override {
+    return std::make_unique<DenseLayer>(*this);
+  }
 
   /**
    * @brief 计算输出向量 output = W * input + b
@@ -28,9 +37,29 @@ public:
    */
   Eigen::VectorXd compute(const Eigen::VectorXd &x) override;
 
+  // --- 训练 ---
+  /// 批量前向 Y = W * X + b
+  Eigen::MatrixXd computeBatch(Eigen::Ref<const Eigen::MatrixXd> X) override;
+  /**
+   * @brief 批量反向传播
+   * dW += dY * X^T, db += rowsum(dY), dX = W^T * dY
+   */
+  Eigen::MatrixXd backward(const Eigen::MatrixXd &X, const Eigen::MatrixXd &Y,
+                           const Eigen::MatrixXd &dY, LayerGradient &grad,
+                           bool need_dX) const override;
+  void initGradient(LayerGradient &grad) const override;
+  void applyStep(const LayerGradient &step) override;
+
+  /**
+   * @brief 随机初始化参数，与 PyTorch nn.Linear 默认初始化一致
+   * W, b ~ U(-1/sqrt(input_dim), 1/sqrt(input_dim))
+   */
+  void initRandom(std::mt19937 &rng);
+
 private:
   int _input_dimension = 0;
   int _output_dimension = 0;
   Eigen::MatrixXd W;
   Eigen::VectorXd b;
+  std::shared_ptr<const GemmBackend> _backend;
 };
\ No newline at end of file
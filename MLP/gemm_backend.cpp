@@ -0,0 +1,173 @@
+#include "gemm_backend.h"
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef MLP_HAVE_CBLAS
+#include <cblas.h>
+#ifdef MLP_CBLAS_BLIS
+#include <blis.h>
+#endif
+#endif
+
+#ifndef MLP_DEFAULT_GEMM_BACKEND
+#define MLP_DEFAULT_GEMM_BACKEND "eigen"
+#endif
+
+namespace {
+// C = p + beta * C，beta 为 0 时直接赋值
+template <typename Product>
+void accumulate(GemmBackend::MatrixRef &C, double beta, const Product &p) {
+  if (beta == 0.0) {
+    C.noalias() = p;
+    return;
+  }
+  if (beta != 1.0) {
+    C *= beta;
+  }
+  C.noalias() += p;
+}
+
+class EigenGemmBackend : public GemmBackend {
+public:
+  const char *name() const override { return "eigen"; }
+  int threadCount() const override { return Eigen::nbThreads(); }
+
+protected:
+  void gemmImpl(bool transA, bool transB, double alpha,
+                const ConstMatrixRef &A, const ConstMatrixRef &B, double beta,
+                MatrixRef &C) const override {
+    if (!transA && !transB) {
+      accumulate(C, beta, alpha * A * B);
+    } else if (transA && !transB) {
+      accumulate(C, beta, alpha * A.transpose() * B);
+    } else if (!transA && transB) {
+      accumulate(C, beta, alpha * A * B.transpose());
+    } else {
+      accumulate(C, beta, alpha * A.transpose() * B.transpose());
+    }
+  }
+};
+
+class NaiveGemmBackend : public GemmBackend {
+public:
+  const char *name() const override { return "naive"; }
+
+protected:
+  void gemmImpl(bool transA, bool transB, double alpha,
+                const ConstMatrixRef &A, const ConstMatrixRef &B, double beta,
+                MatrixRef &C) const override {
+    const Eigen::Index K = transA ? A.rows() : A.cols();
+    for (Eigen::Index j = 0; j < C.cols(); ++j) {
+      for (Eigen::Index i = 0; i < C.rows(); ++i) {
+        double sum = 0.0;
+        for (Eigen::Index p = 0; p < K; ++p) {
+          const double a = transA ? A(p, i) : A(i, p);
+          const double b = transB ? B(j, p) : B(p, j);
+          sum += a * b;
+        }
+        C(i, j) = alpha * sum + (beta == 0.0 ? 0.0 : beta * C(i, j));
+      }
+    }
+  }
+};
+
+#ifdef MLP_HAVE_CBLAS
+class CblasGemmBackend : public GemmBackend {
+public:
+  CblasGemmBackend() {
+    // 并行由调用方负责，BLAS 保持单线程，见 gemm_backend.h
+#if defined(MLP_CBLAS_OPENBLAS)
+    openblas_set_num_threads(1);
+#elif defined(MLP_CBLAS_BLIS)
+    bli_thread_set_num_threads(1);
+#endif
+  }
+
+  const char *name() const override { return "cblas"; }
+  int threadCount() const override {
+#if defined(MLP_CBLAS_OPENBLAS)
+    return openblas_get_num_threads();
+#elif defined(MLP_CBLAS_BLIS)
+    return static_cast<int>(bli_thread_get_num_threads());
+#else
+    return -1;
+#endif
+  }
+
+protected:
+  void gemmImpl(bool transA, bool transB, double alpha,
+                const ConstMatrixRef &A, const ConstMatrixRef &B, double beta,
+                MatrixRef &C) const override {
+    const int M = static_cast<int>(C.rows());
+    const int N = static_cast<int>(C.cols());
+    const int K = static_cast<int>(transA ? A.rows() : A.cols());
+    cblas_dgemm(CblasColMajor, transA ? CblasTrans : CblasNoTrans,
+                transB ? CblasTrans : CblasNoTrans, M, N, K, alpha, A.data(),
+                static_cast<int>(A.outerStride()), B.data(),
+                static_cast<int>(B.outerStride()), beta, C.data(),
+                static_cast<int>(C.outerStride()));
+  }
+};
+#endif
+} // namespace
+
+void GemmBackend::gemm(bool transA, bool transB, double alpha,
+                       ConstMatrixRef A, ConstMatrixRef B, double beta,
+                       MatrixRef C) const {
+  const Eigen::Index M = transA ? A.cols() : A.rows();
+  const Eigen::Index K = transA ? A.rows() : A.cols();
+  const Eigen::Index KB = transB ? B.cols() : B.rows();
+  const Eigen::Index N = transB ? B.rows() : B.cols();
+  if (K != KB || C.rows() != M || C.cols() != N) {
+    throw std::invalid_argument("GEMM 矩阵维度不匹配");
+  }
+  if (M == 0 || N == 0) {
+    return;
+  }
+  gemmImpl(transA, transB, alpha, A, B, beta, C);
+}
+
+std::shared_ptr<const GemmBackend>
+GemmBackend::create(const std::string &name) {
+  static const auto eigen = std::make_shared<const EigenGemmBackend>();
+  static const auto naive = std::make_shared<const NaiveGemmBackend>();
+  if (name == "eigen") {
+    return eigen;
+  }
+  if (name == "naive") {
+    return naive;
+  }
+#ifdef MLP_HAVE_CBLAS
+  static const auto cblas = std::make_shared<const CblasGemmBackend>();
+  if (name == "cblas") {
+    return cblas;
+  }
+#endif
+  throw std::invalid_argument("Unknown or unavailable GEMM backend: " + name);
+}
+
+std::shared_ptr<const GemmBackend> GemmBackend::defaultBackend() {
+  // 每个 DenseLayer 构造都会调用，只解析一次环境变量，警告也只打印一次
+  static const std::shared_ptr<const GemmBackend> backend = [] {
+    const char *env = std::getenv("MLP_GEMM_BACKEND");
+    if (env != nullptr && *env != '\0') {
+      try {
+        return create(env);
+      } catch (const std::invalid_argument &e) {
+        std::cerr << "Warning: " << e.what() << ", using "
+                  << MLP_DEFAULT_GEMM_BACKEND << std::endl;
+      }
+    }
+    return create(MLP_DEFAULT_GEMM_BACKEND);
+  }();
+  return backend;
+}
+
+std::vector<std::string> GemmBackend::available() {
+  std::vector<std::string> names = {"eigen", "naive"};
+#ifdef MLP_HAVE_CBLAS
+  names.push_back("cblas");
+#endif
+  return names;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 矩阵乘法后端：C = alpha * op(A) * op(B) + beta * C
+ *
+ * 矩阵均为列主序（与 Eigen::MatrixXd 一致），op(X) 为 X 或 X^T。
+ * beta 为 0 时不读取 C 的原值（与 BLAS 语义一致）。
+ * 后端无状态，可在多个线程、多个网络间共享。
+ *
+ * 可用后端：
+ *  - "eigen"：Eigen 内置 GEMM（默认）
+ *  - "naive"：三重循环参考实现，用于校验与对比
+ *  - "cblas"：配置时找到 CBLAS（OpenBLAS / BLIS 等）才可用
+ *
+ * 调用方（Trainer、NumaExecutor）已经按核心并行，BLAS 再开内部线程会超订
+ * 核心，且这些线程不绑核、会跨节点读取权重。因此 cblas 后端创建时把
+ * OpenBLAS / BLIS 的线程数设为 1（进程级设置）；其他 BLAS 实现无法自动
+ * 设置，请通过 OMP_NUM_THREADS=1 等环境变量限制，并用 threadCount() 确认。
+ */
+class GemmBackend {
+public:
+  using MatrixRef = Eigen::Ref<Eigen::MatrixXd>;
+  using ConstMatrixRef = Eigen::Ref<const Eigen::MatrixXd>;
+
+  virtual ~GemmBackend() = default;
+  virtual const char *name() const = 0;
+  /// 后端内部使用的线程数，无法查询时返回 -1
+  virtual int threadCount() const { return 1; }
+
+  /**
+   * @throws std::invalid_argument 如果矩阵维度不匹配
+   */
+  void gemm(bool transA, bool transB, double alpha, ConstMatrixRef A,
+            ConstMatrixRef B, double beta, MatrixRef C) const;
+
+  /**
+   * @brief 按名称获取后端
+   * @throws std::invalid_argument 如果名称未知或该后端未编译进来
+   */
+  static std::shared_ptr<const GemmBackend> create(const std::string &name);
+  /**
+   * @brief 默认后端：环境变量 MLP_GEMM_BACKEND 优先，
+   * 其次是构建时的 MLP_DEFAULT_GEMM_BACKEND（CMake 选项 MLP_GEMM_BACKEND）
+   * 只在首次调用时解析，之后的环境变量修改不再生效
+   */
+  static std::shared_ptr<const GemmBackend> defaultBackend();
+  /// 当前构建中可用的后端名称
+  static std::vector<std::string> available();
+
+protected:
+  virtual void gemmImpl(bool transA, bool transB, double alpha,
+                        const ConstMatrixRef &A, const ConstMatrixRef &B,
+                        double beta, MatrixRef &C) const = 0;
+};
@@ -1,6 +1,15 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <memory>
+
+/// 单层的参数梯度，无参数的层（如激活层）保持为空
+struct LayerGradient {
+  Eigen::MatrixXd dW;
+  Eigen::VectorXd db;
+
+  bool empty() const { return dW.size() == 0 && db.size() == 0; }
+};
 
 class Layer {
 public:
@@ -8,4 +17,37 @@ public:
   virtual Eigen::VectorXd compute(const Eigen::VectorXd &x) = 0;
   virtual int inputDim() const = 0;
   virtual int outputDim() const = 0;
-};
\ No newline at end of file
+  /// 深拷贝，参数内存由调用线程分配（NUMA first-touch 依赖这一点）
+  virtual std::unique_ptr<Layer> clone() const = 0;
+
+  // --- 训练（批量接口，矩阵每一列是一个样本）---
+  /// 批量前向，默认逐列调用 compute
+  /// 参数为 Ref，传入列块（如 scratch.leftCols(n)）时不会拷贝
+  virtual Eigen::MatrixXd computeBatch(Eigen::Ref<const Eigen::MatrixXd> X) {
+    Eigen::MatrixXd Y(outputDim(), X.cols());
+    for (Eigen::Index i = 0; i < X.cols(); ++i) {
+      Y.col(i) = compute(X.col(i));
+    }
+    return Y;
+  }
+
+  /**
+   * @brief 批量反向传播：由输出梯度计算输入梯度，并把参数梯度累加到 grad
+   * @param X 前向时的输入 [input_dim × batch]
+   * @param Y 前向时的输出 [output_dim × batch]
+   * @param dY 损失对 Y 的梯度
+   * @param grad 参数梯度累加器，需先经 initGradient 初始化
+   * @param need_dX 为 false 时不计算输入梯度（网络第一层），返回空矩阵
+   * @return 损失对 X 的梯度
+   * @note 只读层的参数，可在多个线程中并发调用（各线程使用各自的 grad）
+   */
+  virtual Eigen::MatrixXd backward(const Eigen::MatrixXd &X,
+                                   const Eigen::MatrixXd &Y,
+                                   const Eigen::MatrixXd &dY,
+                                   LayerGradient &grad, bool need_dX) const = 0;
+
+  /// 按本层参数形状分配并清零梯度，无参数的层什么都不做
+  virtual void initGradient(LayerGradient &grad) const { (void)grad; }
+  /// 参数更新：param -= step，无参数的层什么都不做
+  virtual void applyStep(const LayerGradient &step) { (void)step; }
+};
@@ -0,0 +1,43 @@
+#include "loss.h"
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+namespace {
+void check_label(Eigen::Index classes, int label) {
+  if (label < 0 || label >= classes) {
+    throw std::invalid_argument("标签越界");
+  }
+}
+
+// log(sum(exp(x)))，先减去最大值保证数值稳定
+double log_sum_exp(const Eigen::VectorXd &x) {
+  const double m = x.maxCoeff();
+  return m + std::log((x.array() - m).exp().sum());
+}
+} // namespace
+
+double CrossEntropyLoss::compute(const Eigen::VectorXd &logits, int label) {
+  check_label(logits.size(), label);
+  return log_sum_exp(logits) - logits[label];
+}
+
+double CrossEntropyLoss::gradient(const Eigen::MatrixXd &logits,
+                                  const std::vector<int> &labels,
+                                  Eigen::MatrixXd &grad) {
+  if (static_cast<size_t>(logits.cols()) != labels.size()) {
+    throw std::invalid_argument("标签数量与样本数不匹配");
+  }
+
+  grad.resize(logits.rows(), logits.cols());
+  double loss = 0.0;
+  for (Eigen::Index i = 0; i < logits.cols(); ++i) {
+    const int label = labels[i];
+    check_label(logits.rows(), label);
+    const double lse = log_sum_exp(logits.col(i));
+    grad.col(i) = (logits.col(i).array() - lse).exp();
+    grad(label, i) -= 1.0;
+    loss += lse - logits(label, i);
+  }
+  return loss;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <vector>
+
+/// 交叉熵损失，与 PyTorch nn.CrossEntropyLoss 一致（作用于 Softmax 之前的 logits）
+class CrossEntropyLoss {
+public:
+  /**
+   * @brief 计算单个样本的损失 -log(softmax(logits)[label])
+   * @throws std::invalid_argument 如果 label 越界
+   */
+  static double compute(const Eigen::VectorXd &logits, int label);
+
+  /**
+   * @brief 批量计算损失对 logits 的梯度 softmax(logits) - onehot(label)
+   * @param logits [类别数 × batch]，每一列是一个样本
+   * @param labels 长度为 batch 的标签
+   * @param grad 输出，与 logits 同形状
+   * @return 该批样本的损失之和
+   */
+  static double gradient(const Eigen::MatrixXd &logits,
+                         const std::vector<int> &labels, Eigen::MatrixXd &grad);
+};
@@ -2,10 +2,19 @@
 #include "dataset.h"
 #include "dense_layer.h"
 #include "mlp_network.h"
+#include "model_handle.h"
+#include "numa_executor.h"
+#include "optimizer.h"
+#include "trainer.h"
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <random>
 #include <sstream>
+#include <string>
 #include <vector>
 
 MLPNetwork build_mnist_mlp(const std::string &weight_dir) {
@@ -68,9 +77,117 @@ MLPNetwork build_mnist_mlp(const std::string &weight_dir) {
   return net;
 }
 
-int main() {
+// 与 build_mnist_mlp 结构相同，参数随机初始化，用于从头训练
+MLPNetwork create_mnist_mlp(unsigned int seed) {
+  std::mt19937 rng(seed);
+  MLPNetwork net;
+  const int dims[] = {784, 256, 128, 10};
+  for (int i = 0; i < 3; ++i) {
+    auto dense = std::make_unique<DenseLayer>(dims[i], dims[i + 1]);
+    dense->initRandom(rng);
+    net.addLayer(std::move(dense));
+    if (i < 2) {
+      net.addLayer(std::make_unique<ActivationLayer>(
+          ActivationLayer::enActiveFuncType::enReLU, dims[i + 1],
+          dims[i + 1]));
+    }
+  }
+  net.addLayer(std::make_unique<ActivationLayer>(
+      ActivationLayer::enActiveFuncType::enSoftMax, 10, 10));
+  return net;
+}
+
+// 加载 `MLP train` 生成的权重文件（MLPNetwork::saveWeights 格式）
+MLPNetwork load_trained_mnist_mlp(const std::string &weight_file) {
+  MLPNetwork net = create_mnist_mlp(0);
+  net.loadWeights(weight_file);
+  return net;
+}
+
+// 整个字符串都是正整数时返回 true
+bool parse_positive_int(const char *text, int &value) {
+  const char *end = text + std::strlen(text);
+  auto [ptr, ec] = std::from_chars(text, end, value);
+  return ec == std::errc() && ptr == end && value > 0;
+}
+
+int train_usage(const char *prog) {
+  std::cerr << "usage: " << prog
+            << " train <train-images-idx3-ubyte> <train-labels-idx1-ubyte> "
+               "<t10k-images-idx3-ubyte> <t10k-labels-idx1-ubyte> "
+               "<out.yml> [epochs] [threads]\n"
+               "  epochs, threads: positive integers\n";
+  return 1;
+}
+
+// MLP train <train-images> <train-labels> <test-images> <test-labels>
+//           <out.yml> [epochs] [threads]
+int train_main(int argc, char **argv) {
+  if (argc < 7 || argc > 9) {
+    return train_usage(argv[0]);
+  }
+
+  // 超参数与 train/MNSET_Train.ipynb 一致：Adam(lr=1e-3), batch 64, 5 epochs
+  TrainConfig config;
+  if (argc > 7 && !parse_positive_int(argv[7], config.epochs)) {
+    return train_usage(argv[0]);
+  }
+  if (argc > 8) {
+    int threads = 0;
+    if (!parse_positive_int(argv[8], threads)) {
+      return train_usage(argv[0]);
+    }
+    config.num_threads = static_cast<size_t>(threads);
+  }
+
+  DataSet train_set;
+  train_set.load_mnist_idx(argv[2], argv[3]);
+  DataSet test_set;
+  test_set.load_mnist_idx(argv[4], argv[5]);
+  std::cout << "train samples = " << train_set.getDataSet().size()
+            << ", test samples = " << test_set.getDataSet().size()
+            << std::endl;
+
+  MLPNetwork net = create_mnist_mlp(config.seed);
+  AdamOptimizer optimizer(1e-3);
+  Trainer trainer(net, optimizer, config);
+  trainer.fit(train_set.getDataSet(), test_set.getDataSet());
+
+  net.saveWeights(argv[6]);
+  std::cout << "Model saved to " << argv[6] << ", run inference with: "
+            << argv[0] << " " << argv[6] << std::endl;
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1 && std::string(argv[1]) == "train") {
+    try {
+      return train_main(argc, argv);
+    } catch (const std::exception &e) {
+      std::cerr << "train failed: " << e.what() << std::endl;
+      return 1;
+    }
+  }
+  if (argc > 1 && std::string(argv[1]) == "test") {
+    try {
+      ActivationLayer::test();
+      Trainer::test();
+      ModelHandle::test();
+      NumaExecutor::test();
+    } catch (const std::exception &e) {
+      // 例如 MLP_NUMA_TOPOLOGY 格式错误
+      std::cerr << "test failed: " << e.what() << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+
+  // MLP [weights.yml]：指定 `MLP train` 的输出时直接使用，否则读取 PyTorch
+  // 导出的 weights_yml 目录
   auto mlp =
-      build_mnist_mlp("D:/projects/AI_infer_learn/MLP/train/weights_yml");
+      argc > 1
+          ? load_trained_mnist_mlp(argv[1])
+          : build_mnist_mlp("D:/projects/AI_infer_learn/MLP/train/weights_yml");
 
   Eigen::MatrixXd all_data = DataSet::load_dataset_from_folder(
       "D:/MNIST数据集/mnist_dataset/mnist_dataset/test/test");
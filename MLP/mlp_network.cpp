@@ -4,7 +4,10 @@
 #include <Eigen/src/Core/Matrix.h>
 #include <cstddef>
 #include <memory>
+#include <opencv2/core.hpp>
+#include <opencv2/core/eigen.hpp>
 #include <stdexcept>
+#include <string>
 
 // --- 网络构建 ---
 void MLPNetwork::addLayer(std::unique_ptr<Layer> layer) {
@@ -23,10 +26,28 @@ bool MLPNetwork::checkConsistency(bool throw_on_error) const {
       }
       return false;
     }
+    preOutDim = _layers[i]->outputDim();
   }
   return true;
 }
 
+MLPNetwork MLPNetwork::clone() const {
+  MLPNetwork net;
+  for (const auto &layer : _layers) {
+    net.addLayer(layer->clone());
+  }
+  return net;
+}
+
+void MLPNetwork::setGemmBackend(std::shared_ptr<const GemmBackend> backend) {
+  for (auto &layer : _layers) {
+    auto *dense = dynamic_cast<DenseLayer *>(layer.get());
+    if (dense != nullptr) {
+      dense->setBackend(backend);
+    }
+  }
+}
+
 // --- 推理 ---
 Eigen::VectorXd MLPNetwork::forward(const Eigen::VectorXd &x) const {
   if (_layers.empty()) {
@@ -40,8 +61,62 @@ Eigen::VectorXd MLPNetwork::forward(const Eigen::VectorXd &x) const {
 }
 
 // --- 权重持久化 ---
-void MLPNetwork::loadWeights(const std::string &fileName) {}
-void MLPNetwork::saveWeights(const std::string &fileName) const {}
+void MLPNetwork::loadWeights(const std::string &fileName) {
+  cv::FileStorage fs(fileName, cv::FileStorage::READ);
+  if (!fs.isOpened()) {
+    throw std::runtime_error("Failed to open weights: " + fileName);
+  }
+
+  int index = 0;
+  for (auto &layer : _layers) {
+    auto *dense = dynamic_cast<DenseLayer *>(layer.get());
+    if (dense == nullptr) {
+      continue;
+    }
+    ++index;
+    const std::string prefix = "fc" + std::to_string(index);
+    cv::Mat w, b;
+    fs[prefix + "_weight"] >> w;
+    fs[prefix + "_bias"] >> b;
+    if (w.empty() || b.empty()) {
+      throw std::runtime_error("Missing " + prefix + " in weights: " +
+                               fileName);
+    }
+    w.convertTo(w, CV_64F);
+    b.convertTo(b, CV_64F);
+
+    Eigen::MatrixXd W;
+    Eigen::MatrixXd B;
+    cv::cv2eigen(w, W);
+    cv::cv2eigen(b, B);
+    dense->setW(W);
+    dense->setB(Eigen::Map<Eigen::VectorXd>(B.data(), B.size()));
+  }
+  fs.release();
+}
+
+void MLPNetwork::saveWeights(const std::string &fileName) const {
+  cv::FileStorage fs(fileName, cv::FileStorage::WRITE);
+  if (!fs.isOpened()) {
+    throw std::runtime_error("Failed to open weights: " + fileName);
+  }
+
+  int index = 0;
+  for (const auto &layer : _layers) {
+    const auto *dense = dynamic_cast<const DenseLayer *>(layer.get());
+    if (dense == nullptr) {
+      continue;
+    }
+    ++index;
+    const std::string prefix = "fc" + std::to_string(index);
+    cv::Mat w, b;
+    cv::eigen2cv(dense->getW(), w);
+    cv::eigen2cv(dense->getB(), b);
+    fs << prefix + "_weight" << w;
+    fs << prefix + "_bias" << b;
+  }
+  fs.release();
+}
 
 // --- 元信息 ---
 int MLPNetwork::inputDim() const {
@@ -12,11 +12,16 @@ public:
   // --- 网络构建 ---
   void addLayer(std::unique_ptr<Layer> layer);
   bool checkConsistency(bool throw_on_error = true) const;
+  /// 深拷贝所有层
+  MLPNetwork clone() const;
+  /// 为所有 DenseLayer 指定矩阵乘法后端
+  void setGemmBackend(std::shared_ptr<const GemmBackend> backend);
 
   // --- 推理 ---
   Eigen::VectorXd forward(const Eigen::VectorXd &x) const;
 
   // --- 权重持久化 ---
+  // 以 OpenCV yml 保存所有 DenseLayer 参数，按顺序命名为 fc1_weight, fc1_bias, ...
   void loadWeights(const std::string &fileName);
   void saveWeights(const std::string &fileName) const;
 
@@ -24,6 +29,9 @@ public:
   int inputDim() const;
   int outputDim() const;
   bool empty() const { return _layers.empty(); }
+  size_t layerCount() const { return _layers.size(); }
+  Layer &layer(size_t i) { return *_layers.at(i); }
+  const Layer &layer(size_t i) const { return *_layers.at(i); }
 
 private:
   std::vector<std::unique_ptr<Layer>> _layers;
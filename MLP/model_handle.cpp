@@ -0,0 +1,252 @@
+#include "model_handle.h"
+#include "dense_layer.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+double elapsed_us(std::chrono::steady_clock::time_point start,
+                  std::chrono::steady_clock::time_point end) {
+  return std::chrono::duration<double, std::micro>(end - start).count();
+}
+} // namespace
+
+ModelHandle::ModelHandle(MLPNetwork &&net) { publish(std::move(net)); }
+
+void ModelHandle::publish(MLPNetwork &&net) {
+  // 在替换前完成全部校验，读者永远看不到未通过校验的模型
+  if (net.empty()) {
+    throw std::runtime_error("MLP NetWork empty layers");
+  }
+  net.checkConsistency();
+
+  auto next = std::make_shared<const MLPNetwork>(std::move(net));
+  std::lock_guard<std::mutex> lock(_mutex);
+  NetworkPtr current = _current.load(std::memory_order_relaxed);
+  if (current != nullptr && (current->inputDim() != next->inputDim() ||
+                             current->outputDim() != next->outputDim())) {
+    throw std::runtime_error("hot swap model dimension mismatch");
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  NetworkPtr old =
+      _current.exchange(std::move(next), std::memory_order_acq_rel);
+  auto end = std::chrono::steady_clock::now();
+
+  if (old != nullptr) {
+    _retired.push_back({std::move(old), end});
+  }
+  ++_metrics.swaps;
+  _metrics.last_swap_us = elapsed_us(start, end);
+  _metrics.max_swap_us = std::max(_metrics.max_swap_us, _metrics.last_swap_us);
+}
+
+size_t ModelHandle::reclaim() {
+  std::vector<NetworkPtr> drained;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto now = std::chrono::steady_clock::now();
+    // use_count()==1 说明只剩待回收列表持有：它已不再是当前模型，
+    // 读者也无法再拿到它，所以这个判断不会被并发读者推翻
+    auto it = std::partition(
+        _retired.begin(), _retired.end(),
+        [](const Retired &r) { return r.net.use_count() > 1; });
+    for (auto r = it; r != _retired.end(); ++r) {
+      _metrics.max_reclaim_us = std::max(_metrics.max_reclaim_us,
+                                         elapsed_us(r->since, now));
+      drained.push_back(std::move(r->net));
+    }
+    _retired.erase(it, _retired.end());
+    _metrics.retired += drained.size();
+  }
+  // 在锁外析构旧模型
+  return drained.size();
+}
+
+void ModelHandle::recordFailure(const std::string &error, double load_us) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  ++_metrics.failed_loads;
+  _metrics.last_error = error;
+  _metrics.last_load_us = load_us;
+}
+
+void ModelHandle::recordLoad(double load_us) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _metrics.last_load_us = load_us;
+}
+
+SwapMetrics ModelHandle::metrics() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  SwapMetrics m = _metrics;
+  m.pending_retire = _retired.size();
+  return m;
+}
+
+// --- 后台加载线程 ---
+ModelReloader::ModelReloader(ModelHandle &handle,
+                             std::chrono::milliseconds reclaim_interval)
+    : _handle(handle), _reclaim_interval(reclaim_interval) {
+  _thread = std::thread(&ModelReloader::run, this);
+}
+
+ModelReloader::~ModelReloader() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _cv.notify_all();
+  _thread.join();
+}
+
+void ModelReloader::requestReload(Loader loader) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pending = std::move(loader);
+  }
+  _cv.notify_all();
+}
+
+void ModelReloader::waitIdle() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _idle_cv.wait(lock, [this] { return !_pending && !_busy; });
+}
+
+void ModelReloader::run() {
+  while (true) {
+    Loader loader;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _cv.wait_for(lock, _reclaim_interval,
+                   [this] { return _stop || _pending; });
+      if (_stop) {
+        return;
+      }
+      loader = std::move(_pending);
+      _pending = nullptr;
+      _busy = static_cast<bool>(loader);
+    }
+
+    if (loader) {
+      auto start = std::chrono::steady_clock::now();
+      try {
+        MLPNetwork net = loader();
+        _handle.recordLoad(
+            elapsed_us(start, std::chrono::steady_clock::now()));
+        _handle.publish(std::move(net));
+      } catch (const std::exception &e) {
+        std::cerr << "Model reload failed: " << e.what() << std::endl;
+        _handle.recordFailure(
+            e.what(), elapsed_us(start, std::chrono::steady_clock::now()));
+      }
+    }
+    _handle.reclaim();
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _busy = false;
+    }
+    _idle_cv.notify_all();
+  }
+}
+
+// --- 测试 ---
+namespace {
+// 两层 DenseLayer，W = g * I，b = 0：完整模型对全 1 输入的输出为 g^2。
+// 只要读者看到的输出不是某个整数代数的平方，就说明拿到了不完整的模型
+MLPNetwork make_generation_mlp(int generation, int dim) {
+  MLPNetwork net;
+  for (int i = 0; i < 2; ++i) {
+    auto dense = std::make_unique<DenseLayer>(dim, dim);
+    dense->setW(Eigen::MatrixXd::Identity(dim, dim) * generation);
+    net.addLayer(std::move(dense));
+  }
+  return net;
+}
+
+bool is_complete_output(const Eigen::VectorXd &y, int &generation) {
+  const double g = std::sqrt(y[0]);
+  generation = static_cast<int>(std::lround(g));
+  return generation >= 1 && std::abs(g - generation) < 1e-9 &&
+         (y.array() == y[0]).all();
+}
+} // namespace
+
+void ModelHandle::test() {
+  std::cout << "Testing ModelHandle hot swap" << std::endl;
+  std::cout << "============================" << std::endl;
+
+  const int dim = 64;
+  const int generations = 200;
+  const int readers = std::max(2u, std::thread::hardware_concurrency());
+
+  ModelHandle handle(make_generation_mlp(1, dim));
+  std::atomic<bool> done{false};
+  std::atomic<long long> requests{0};
+  std::atomic<long long> broken{0};
+  std::atomic<long long> regressions{0};
+
+  std::vector<std::thread> threads;
+  for (int r = 0; r < readers; ++r) {
+    threads.emplace_back([&] {
+      const Eigen::VectorXd x = Eigen::VectorXd::Ones(dim);
+      int last_generation = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        NetworkPtr net = handle.acquire();
+        int generation = 0;
+        if (!is_complete_output(net->forward(x), generation)) {
+          ++broken;
+        }
+        // 同一读者看到的代数不应倒退
+        if (generation < last_generation) {
+          ++regressions;
+        }
+        last_generation = generation;
+        ++requests;
+      }
+    });
+  }
+
+  {
+    ModelReloader reloader(handle, std::chrono::milliseconds(1));
+    for (int g = 2; g <= generations; ++g) {
+      reloader.requestReload([g, dim] { return make_generation_mlp(g, dim); });
+      reloader.waitIdle();
+    }
+    // 维度不同的模型必须被拒绝，当前模型保持不变
+    reloader.requestReload([dim] { return make_generation_mlp(1, dim + 1); });
+    reloader.waitIdle();
+  }
+  done = true;
+  for (auto &t : threads) {
+    t.join();
+  }
+  handle.reclaim();
+
+  SwapMetrics m = handle.metrics();
+  int final_generation = 0;
+  is_complete_output(handle.acquire()->forward(Eigen::VectorXd::Ones(dim)),
+                     final_generation);
+
+  std::cout << "requests = " << requests << ", swaps = " << m.swaps
+            << ", retired = " << m.retired
+            << ", max swap = " << m.max_swap_us << " us"
+            << ", max reclaim = " << m.max_reclaim_us << " us"
+            << std::endl;
+  std::cout << "No half-loaded model: " << (broken == 0 ? "PASSED" : "FAILED")
+            << std::endl;
+  std::cout << "Monotonic generations: "
+            << (regressions == 0 ? "PASSED" : "FAILED") << std::endl;
+  std::cout << "All swaps applied: "
+            << (m.swaps == static_cast<uint64_t>(generations) &&
+                        final_generation == generations
+                    ? "PASSED"
+                    : "FAILED")
+            << std::endl;
+  std::cout << "Mismatched model rejected: "
+            << (m.failed_loads == 1 ? "PASSED" : "FAILED") << std::endl;
+  std::cout << "Old models retired: "
+            << (m.retired == m.swaps - 1 && m.pending_retire == 0 ? "PASSED"
+                                                                   : "FAILED")
+            << std::endl;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "mlp_network.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// 热更新统计，时间单位为微秒
+struct SwapMetrics {
+  uint64_t swaps = 0;        // 成功替换次数
+  uint64_t failed_loads = 0; // 加载或校验失败次数
+  uint64_t retired = 0;      // 已释放的旧模型数量
+  size_t pending_retire = 0; // 仍被在途请求持有、等待释放的旧模型数量
+  double last_load_us = 0.0; // 最近一次加载 + 校验耗时
+  double last_swap_us = 0.0; // 最近一次原子替换耗时
+  double max_swap_us = 0.0;
+  // 旧模型从被替换到被 reclaim() 释放的最长时间；reclaim 按轮询间隔运行，
+  // 所以这是在途请求结束时间的上界（最多多出一个 reclaim_interval）
+  double max_reclaim_us = 0.0;
+  std::string last_error;
+};
+
+/**
+ * @brief 可原子热替换的模型句柄
+ *
+ * 读者通过 acquire() 拿到当前模型的 shared_ptr，不加任何锁；
+ * 持有期间即使模型被替换，拿到的旧模型也保持完整可用。
+ * 写者（publish）校验新模型后一次性原子替换，旧模型放入待回收列表，
+ * 由 reclaim() 在没有读者持有时释放，析构不会落在读者线程上。
+ */
+class ModelHandle {
+public:
+  using NetworkPtr = std::shared_ptr<const MLPNetwork>;
+
+  ModelHandle() = default;
+  explicit ModelHandle(MLPNetwork &&net);
+
+  /// 读者入口，无锁，返回的模型在持有期间保持不变；尚未发布时为空
+  NetworkPtr acquire() const {
+    return _current.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief 校验并原子替换当前模型
+   * 校验：非空、checkConsistency、且输入/输出维度与当前模型一致
+   * @throws std::runtime_error 如果校验失败，此时当前模型不变
+   */
+  void publish(MLPNetwork &&net);
+
+  /// 释放已无读者持有的旧模型，返回本次释放数量
+  size_t reclaim();
+
+  /// 记录一次加载失败（供后台加载线程使用）
+  void recordFailure(const std::string &error, double load_us);
+  /// 记录最近一次加载耗时
+  void recordLoad(double load_us);
+
+  SwapMetrics metrics() const;
+
+  /// 并发压力测试：多个读者持续推理，写者不断热替换
+  static void test();
+
+private:
+  struct Retired {
+    NetworkPtr net;
+    std::chrono::steady_clock::time_point since;
+  };
+
+  std::atomic<NetworkPtr> _current;
+  mutable std::mutex _mutex; // 只保护写者侧状态，读者不会访问
+  std::vector<Retired> _retired;
+  SwapMetrics _metrics;
+};
+
+/**
+ * @brief 后台加载线程：加载新模型（如 build_mnist_mlp）、校验并热替换
+ * 多次请求只保留最新一次；空闲时定期回收旧模型。
+ */
+class ModelReloader {
+public:
+  using Loader = std::function<MLPNetwork()>;
+
+  explicit ModelReloader(ModelHandle &handle,
+                         std::chrono::milliseconds reclaim_interval =
+                             std::chrono::milliseconds(50));
+  ~ModelReloader();
+  ModelReloader(const ModelReloader &) = delete;
+  ModelReloader &operator=(const ModelReloader &) = delete;
+
+  /// 异步请求重新加载，立即返回
+  void requestReload(Loader loader);
+  /// 阻塞直到当前已提交的请求全部处理完
+  void waitIdle();
+
+private:
+  void run();
+
+  ModelHandle &_handle;
+  std::chrono::milliseconds _reclaim_interval;
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::condition_variable _idle_cv;
+  Loader _pending;
+  bool _busy = false;
+  bool _stop = false;
+  std::thread _thread;
+};
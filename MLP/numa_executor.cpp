@@ -0,0 +1,254 @@
+#include "numa_executor.h"
+#include "activation_layer.h"
+#include "dense_layer.h"
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <cstdlib>
+#include <string>
+
+namespace {
+std::vector<int> worker_cpus(const NumaNode &node, int threads_per_node) {
+  std::vector<int> cpus = node.cpus;
+  if (threads_per_node > 0 &&
+      static_cast<size_t>(threads_per_node) < cpus.size()) {
+    cpus.resize(threads_per_node);
+  }
+  return cpus;
+}
+} // namespace
+
+NumaExecutor::NumaExecutor(const MLPNetwork &net, const NumaTopology &topology,
+                           const NumaConfig &config)
+    : _topology(topology), _config(config),
+      _workers([&] {
+        const std::vector<int> allowed = NumaTopology::allowedCpus();
+        std::vector<Worker> workers;
+        for (size_t n = 0; n < topology.nodeCount(); ++n) {
+          bool first = true;
+          for (int cpu :
+               worker_cpus(topology.nodes()[n], config.threads_per_node)) {
+            Worker worker;
+            worker.node = n;
+            // 模拟拓扑的 CPU 编号是虚构的，轮流映射到本进程可用的 CPU；
+            // 探测到的编号是真实可用的 CPU，原样绑定
+            worker.cpu = topology.isSimulated()
+                             ? allowed[static_cast<size_t>(cpu) % allowed.size()]
+                             : cpu;
+            worker.owns_replica = first;
+            first = false;
+            workers.push_back(std::move(worker));
+          }
+        }
+        return workers;
+      }()),
+      _replicas(topology.nodeCount()),
+      _pool(_workers.size() + 1, [this](size_t id) {
+        // 绑核失败（受限的 cpuset、不支持的平台）时继续以普通线程运行
+        if (_config.pin_threads) {
+          pin_current_thread(_workers[id - 1].cpu);
+        }
+      }) {
+  if (net.empty()) {
+    throw std::runtime_error("MLP NetWork empty layers");
+  }
+  if (_workers.empty() || _config.chunk_size <= 0) {
+    throw std::invalid_argument("NUMA 配置非法");
+  }
+  net.checkConsistency();
+
+  // 在各节点已绑核的线程里拷贝权重并分配 scratch（first-touch）
+  const int input_dim = net.inputDim();
+  _pool.run([&](size_t id) {
+    if (id == 0) {
+      return;
+    }
+    Worker &worker = _workers[id - 1];
+    if (worker.owns_replica) {
+      _replicas[worker.node] = net.clone();
+    }
+    worker.scratch = Eigen::MatrixXd::Zero(input_dim, _config.chunk_size);
+  });
+}
+
+NumaExecutor::NumaExecutor(const MLPNetwork &net, const NumaConfig &config)
+    : NumaExecutor(net, NumaTopology::fromEnv(), config) {}
+
+std::vector<Eigen::VectorXd>
+NumaExecutor::forwardBatch(const std::vector<Eigen::VectorXd> &inputs) {
+  std::vector<Eigen::VectorXd> outputs(inputs.size());
+  if (inputs.empty()) {
+    return outputs;
+  }
+
+  const size_t workers = _workers.size();
+  const size_t chunk = static_cast<size_t>(_config.chunk_size);
+  _pool.run([&](size_t id) {
+    if (id == 0) {
+      return;
+    }
+    Worker &worker = _workers[id - 1];
+    MLPNetwork &net = _replicas[worker.node];
+    const size_t begin = inputs.size() * (id - 1) / workers;
+    const size_t end = inputs.size() * id / workers;
+
+    for (size_t i = begin; i < end; i += chunk) {
+      const size_t count = std::min(chunk, end - i);
+      for (size_t c = 0; c < count; ++c) {
+        if (inputs[i + c].size() != worker.scratch.rows()) {
+          throw std::invalid_argument("输入向量维度不匹配");
+        }
+        worker.scratch.col(c) = inputs[i + c];
+      }
+      Eigen::MatrixXd out =
+          net.layer(0).computeBatch(worker.scratch.leftCols(count));
+      for (size_t l = 1; l < net.layerCount(); ++l) {
+        out = net.layer(l).computeBatch(out);
+      }
+      for (size_t c = 0; c < count; ++c) {
+        outputs[i + c] = out.col(c);
+      }
+    }
+  });
+  return outputs;
+}
+
+// --- 测试 ---
+namespace {
+void set_env(const char *name, const char *value) {
+#if defined(_WIN32)
+  _putenv_s(name, value == nullptr ? "" : value);
+#else
+  if (value == nullptr) {
+    unsetenv(name);
+  } else {
+    setenv(name, value, 1);
+  }
+#endif
+}
+
+// MLP_NUMA_TOPOLOGY 的解析与错误处理
+void test_env_topology() {
+  const char *old = std::getenv("MLP_NUMA_TOPOLOGY");
+  const std::string saved = old == nullptr ? "" : old;
+
+  set_env("MLP_NUMA_TOPOLOGY", "3x2");
+  NumaTopology topology = NumaTopology::fromEnv();
+  std::cout << "MLP_NUMA_TOPOLOGY=3x2 parsed: "
+            << (topology.isSimulated() && topology.nodeCount() == 3 &&
+                        topology.cpuCount() == 6
+                    ? "PASSED"
+                    : "FAILED")
+            << std::endl;
+
+  bool rejected = true;
+  for (const char *bad : {"2y4", "0x2", "2x-1", "abc", "2x4junk", "2x"}) {
+    set_env("MLP_NUMA_TOPOLOGY", bad);
+    try {
+      NumaTopology::fromEnv();
+      rejected = false;
+      std::cout << "accepted invalid MLP_NUMA_TOPOLOGY=" << bad << std::endl;
+    } catch (const std::invalid_argument &) {
+    }
+  }
+  std::cout << "Invalid MLP_NUMA_TOPOLOGY rejected: "
+            << (rejected ? "PASSED" : "FAILED") << std::endl;
+
+  set_env("MLP_NUMA_TOPOLOGY", saved.empty() ? nullptr : saved.c_str());
+}
+
+// 探测到的 CPU 都必须在本进程的亲和性掩码内
+void test_detect_affinity() {
+  const std::vector<int> allowed = NumaTopology::allowedCpus();
+  const NumaTopology topology = NumaTopology::detect();
+  bool inside = topology.nodeCount() > 0;
+  for (const auto &node : topology.nodes()) {
+    inside = inside && !node.cpus.empty();
+    for (int cpu : node.cpus) {
+      inside = inside &&
+               std::find(allowed.begin(), allowed.end(), cpu) != allowed.end();
+    }
+  }
+  std::cout << "Detected CPUs within affinity mask: "
+            << (inside ? "PASSED" : "FAILED") << std::endl;
+}
+} // namespace
+
+void NumaExecutor::test() {
+  std::cout << "Testing NumaExecutor" << std::endl;
+  std::cout << "====================" << std::endl;
+
+  std::mt19937 rng(7);
+  MLPNetwork net;
+  auto dense1 = std::make_unique<DenseLayer>(32, 16);
+  dense1->initRandom(rng);
+  net.addLayer(std::move(dense1));
+  net.addLayer(std::make_unique<ActivationLayer>(
+      ActivationLayer::enActiveFuncType::enReLU, 16, 16));
+  auto dense2 = std::make_unique<DenseLayer>(16, 10);
+  dense2->initRandom(rng);
+  net.addLayer(std::move(dense2));
+  net.addLayer(std::make_unique<ActivationLayer>(
+      ActivationLayer::enActiveFuncType::enSoftMax, 10, 10));
+
+  std::vector<Eigen::VectorXd> inputs;
+  for (int i = 0; i < 1000; ++i) {
+    inputs.push_back(Eigen::VectorXd::Random(32));
+  }
+
+  auto check_executor = [&](const std::string &name, NumaExecutor &executor) {
+    const NumaTopology &topology = executor.topology();
+    std::vector<Eigen::VectorXd> outputs = executor.forwardBatch(inputs);
+
+    bool match = outputs.size() == inputs.size();
+    for (size_t i = 0; match && i < inputs.size(); ++i) {
+      match = (outputs[i] - net.forward(inputs[i])).norm() < 1e-9;
+    }
+    // 每个节点一份独立的权重副本
+    bool replicated = true;
+    for (size_t n = 1; n < topology.nodeCount(); ++n) {
+      const auto &a =
+          dynamic_cast<const DenseLayer &>(executor.replica(0).layer(0));
+      const auto &b =
+          dynamic_cast<const DenseLayer &>(executor.replica(n).layer(0));
+      replicated = replicated && a.getW().data() != b.getW().data();
+    }
+    std::cout << topology.toString() << std::endl;
+    std::cout << name << " matches forward: " << (match ? "PASSED" : "FAILED")
+              << std::endl;
+    std::cout << name << " per-node replicas: "
+              << (replicated && executor.workerCount() == topology.cpuCount()
+                      ? "PASSED"
+                      : "FAILED")
+              << std::endl;
+  };
+  auto check = [&](const std::string &name, const NumaTopology &topology) {
+    NumaConfig config;
+    config.chunk_size = 16;
+    NumaExecutor executor(net, topology, config);
+    check_executor(name, executor);
+  };
+
+  test_env_topology();
+  test_detect_affinity();
+
+  // 与生产路径一致：拓扑来自 MLP_NUMA_TOPOLOGY，未设置时为本机探测结果
+  {
+    NumaConfig config;
+    config.chunk_size = 16;
+    NumaExecutor executor(net, config);
+    check_executor("Environment topology", executor);
+  }
+  {
+    const char *old = std::getenv("MLP_NUMA_TOPOLOGY");
+    const std::string saved = old == nullptr ? "" : old;
+    set_env("MLP_NUMA_TOPOLOGY", "2x3");
+    NumaExecutor executor(net);
+    check_executor("MLP_NUMA_TOPOLOGY=2x3", executor);
+    set_env("MLP_NUMA_TOPOLOGY", saved.empty() ? nullptr : saved.c_str());
+  }
+  check("Detected topology", NumaTopology::detect());
+  check("Simulated 2x2", NumaTopology::simulated(2, 2));
+  check("Simulated 4x1", NumaTopology::simulated(4, 1));
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "mlp_network.h"
+#include "numa_topology.h"
+#include "thread_pool.h"
+#include <Eigen/Dense>
+#include <vector>
+
+struct NumaConfig {
+  int threads_per_node = 0; // 0 表示使用节点上的全部 CPU
+  bool pin_threads = true;  // 是否把 worker 绑定到所属节点的 CPU
+  int chunk_size = 64;      // 每个 worker 一次处理的样本数（scratch 列数）
+};
+
+/**
+ * @brief NUMA 感知的批量推理
+ *
+ * 每个节点持有一份网络副本，由该节点上已绑核的 worker 拷贝生成，
+ * 依靠 first-touch 策略把权重页分配在本地内存；每个 worker 的 scratch
+ * 缓冲区也在自己的线程中分配。推理时每个 worker 只读本节点的副本。
+ * 单节点机器上退化为一份副本 + 普通线程池。
+ */
+class NumaExecutor {
+public:
+  NumaExecutor(const MLPNetwork &net, const NumaTopology &topology,
+               const NumaConfig &config = NumaConfig());
+  /// 拓扑取自 NumaTopology::fromEnv()（MLP_NUMA_TOPOLOGY 或本机探测）
+  explicit NumaExecutor(const MLPNetwork &net,
+                        const NumaConfig &config = NumaConfig());
+
+  /// 批量推理，结果顺序与 inputs 一致
+  std::vector<Eigen::VectorXd>
+  forwardBatch(const std::vector<Eigen::VectorXd> &inputs);
+
+  const NumaTopology &topology() const { return _topology; }
+  size_t workerCount() const { return _workers.size(); }
+  /// 第 node 个节点的网络副本
+  const MLPNetwork &replica(size_t node) const { return _replicas.at(node); }
+
+  static void test();
+
+private:
+  struct Worker {
+    size_t node = 0; // 在 _topology.nodes() 中的下标
+    int cpu = -1;
+    bool owns_replica = false; // 是否负责生成本节点的副本
+    Eigen::MatrixXd scratch;   // [input_dim × chunk_size]
+  };
+
+  NumaTopology _topology;
+  NumaConfig _config;
+  std::vector<Worker> _workers;
+  std::vector<MLPNetwork> _replicas;
+  // worker i 对应线程池中的 i + 1，线程池的 0 号（调用线程）只负责调度
+  ThreadPool _pool;
+};
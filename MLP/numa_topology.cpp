@@ -0,0 +1,191 @@
+#include "numa_topology.h"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace {
+// 解析 cpulist 格式，如 "0-3,8-11"
+std::vector<int> parse_cpu_list(const std::string &text) {
+  std::vector<int> cpus;
+  std::stringstream ss(text);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (item.empty() || item == "\n") {
+      continue;
+    }
+    const size_t dash = item.find('-');
+    const int first = std::stoi(item.substr(0, dash));
+    const int last =
+        dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+} // namespace
+
+std::vector<int> NumaTopology::allowedCpus() {
+  std::vector<int> cpus;
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#elif defined(_WIN32)
+  DWORD_PTR process_mask = 0;
+  DWORD_PTR system_mask = 0;
+  if (GetProcessAffinityMask(GetCurrentProcess(), &process_mask,
+                             &system_mask)) {
+    for (int cpu = 0; cpu < static_cast<int>(sizeof(DWORD_PTR) * 8); ++cpu) {
+      if (process_mask & (DWORD_PTR(1) << cpu)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  if (cpus.empty()) {
+    const int count =
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int cpu = 0; cpu < count; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+NumaTopology NumaTopology::detect() {
+  NumaTopology topology;
+  const std::vector<int> allowed = allowedCpus();
+#if defined(__linux__)
+  const std::filesystem::path root = "/sys/devices/system/node";
+  std::error_code ec;
+  for (const auto &entry : std::filesystem::directory_iterator(root, ec)) {
+    const std::string name = entry.path().filename().string();
+    if (name.rfind("node", 0) != 0 ||
+        name.find_first_not_of("0123456789", 4) != std::string::npos ||
+        name.size() == 4) {
+      continue;
+    }
+    std::ifstream in(entry.path() / "cpulist");
+    std::string text;
+    if (!std::getline(in, text)) {
+      continue;
+    }
+    NumaNode node;
+    node.id = std::stoi(name.substr(4));
+    // 只保留本进程允许运行的 CPU（taskset / cgroup cpuset 限制）
+    for (int cpu : parse_cpu_list(text)) {
+      if (std::binary_search(allowed.begin(), allowed.end(), cpu)) {
+        node.cpus.push_back(cpu);
+      }
+    }
+    // 只有内存没有（可用）CPU 的节点不参与调度
+    if (!node.cpus.empty()) {
+      topology._nodes.push_back(std::move(node));
+    }
+  }
+  std::sort(topology._nodes.begin(), topology._nodes.end(),
+            [](const NumaNode &a, const NumaNode &b) { return a.id < b.id; });
+#endif
+
+  if (topology._nodes.empty()) {
+    NumaNode node;
+    node.cpus = allowed;
+    topology._nodes.push_back(std::move(node));
+  }
+  return topology;
+}
+
+NumaTopology NumaTopology::simulated(int nodes, int cpus_per_node) {
+  if (nodes <= 0 || cpus_per_node <= 0) {
+    throw std::invalid_argument("模拟拓扑的节点数和 CPU 数必须大于0");
+  }
+  NumaTopology topology;
+  topology._simulated = true;
+  for (int n = 0; n < nodes; ++n) {
+    NumaNode node;
+    node.id = n;
+    for (int c = 0; c < cpus_per_node; ++c) {
+      node.cpus.push_back(n * cpus_per_node + c);
+    }
+    topology._nodes.push_back(std::move(node));
+  }
+  return topology;
+}
+
+NumaTopology NumaTopology::fromEnv() {
+  const char *env = std::getenv("MLP_NUMA_TOPOLOGY");
+  if (env == nullptr || *env == '\0') {
+    return detect();
+  }
+  int nodes = 0;
+  int cpus = 0;
+  char x = 0;
+  std::istringstream iss(env);
+  if (!(iss >> nodes >> x >> cpus) || x != 'x' || !(iss >> std::ws).eof()) {
+    throw std::invalid_argument(
+        std::string("MLP_NUMA_TOPOLOGY 格式应为 <节点数>x<每节点CPU数>: ") +
+        env);
+  }
+  return simulated(nodes, cpus);
+}
+
+size_t NumaTopology::cpuCount() const {
+  size_t count = 0;
+  for (const auto &node : _nodes) {
+    count += node.cpus.size();
+  }
+  return count;
+}
+
+std::string NumaTopology::toString() const {
+  std::ostringstream oss;
+  oss << _nodes.size() << " node(s)" << (_simulated ? " (simulated)" : "");
+  for (const auto &node : _nodes) {
+    oss << "\n  node" << node.id << ": " << node.cpus.size() << " cpu(s)";
+  }
+  return oss.str();
+}
+
+bool pin_current_thread(int cpu) {
+  if (cpu < 0) {
+    return false;
+  }
+#if defined(__linux__)
+  if (cpu >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+  if (cpu >= 64) {
+    return false;
+  }
+  return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#else
+  return false;
+#endif
+}
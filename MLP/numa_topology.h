@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct NumaNode {
+  int id = 0;
+  std::vector<int> cpus; // 属于该节点的逻辑 CPU 编号
+};
+
+/**
+ * @brief NUMA 拓扑：节点及其 CPU 列表
+ *
+ * Linux 下从 /sys/devices/system/node 读取，并与进程的 CPU 亲和性掩码
+ * 取交集（taskset、容器 cpuset 限制），没有可用 CPU 的节点被丢弃；
+ * 读取失败或其他平台退化为单节点（包含全部可用 CPU）。也可以构造模拟
+ * 拓扑，在单节点机器上测试多节点的调度逻辑。
+ */
+class NumaTopology {
+public:
+  /// 探测本机拓扑，失败时返回单节点
+  static NumaTopology detect();
+  /// 模拟拓扑：nodes 个节点，每个节点 cpus_per_node 个 CPU，编号连续
+  static NumaTopology simulated(int nodes, int cpus_per_node);
+  /**
+   * @brief 优先读取环境变量 MLP_NUMA_TOPOLOGY（格式 "<节点数>x<每节点CPU数>"，
+   * 如 "2x4"）构造模拟拓扑，未设置时调用 detect()
+   * @throws std::invalid_argument 如果环境变量格式错误
+   */
+  static NumaTopology fromEnv();
+  /// 本进程允许运行的 CPU 编号（升序），无法查询时为 0..硬件线程数-1
+  static std::vector<int> allowedCpus();
+
+  const std::vector<NumaNode> &nodes() const { return _nodes; }
+  size_t nodeCount() const { return _nodes.size(); }
+  size_t cpuCount() const;
+  bool isSimulated() const { return _simulated; }
+  std::string toString() const;
+
+private:
+  std::vector<NumaNode> _nodes;
+  bool _simulated = false;
+};
+
+/**
+ * @brief 把当前线程绑定到逻辑 CPU（编号原样使用，不做映射）
+ * @return 平台不支持、CPU 不存在或不在允许的 cpuset 中时返回 false，
+ *         调用方可忽略
+ */
+bool pin_current_thread(int cpu);
@@ -0,0 +1,92 @@
+#include "optimizer.h"
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+namespace {
+void check_grads(const MLPNetwork &net,
+                 const std::vector<LayerGradient> &grads) {
+  if (grads.size() != net.layerCount()) {
+    throw std::invalid_argument("梯度数量与网络层数不匹配");
+  }
+}
+
+// 按 grads 的形状初始化状态（首次调用时）
+void init_state(std::vector<LayerGradient> &state,
+                const std::vector<LayerGradient> &grads) {
+  if (state.size() == grads.size()) {
+    return;
+  }
+  state.resize(grads.size());
+  for (size_t i = 0; i < grads.size(); ++i) {
+    state[i].dW = Eigen::MatrixXd::Zero(grads[i].dW.rows(), grads[i].dW.cols());
+    state[i].db = Eigen::VectorXd::Zero(grads[i].db.size());
+  }
+}
+} // namespace
+
+SGDOptimizer::SGDOptimizer(double lr, double momentum)
+    : _lr(lr), _momentum(momentum) {
+  if (lr <= 0.0 || momentum < 0.0) {
+    throw std::invalid_argument("SGD 超参数非法");
+  }
+}
+
+void SGDOptimizer::step(MLPNetwork &net,
+                        const std::vector<LayerGradient> &grads) {
+  check_grads(net, grads);
+  init_state(_velocity, grads);
+
+  LayerGradient update;
+  for (size_t i = 0; i < grads.size(); ++i) {
+    if (grads[i].empty()) {
+      continue;
+    }
+    LayerGradient &v = _velocity[i];
+    v.dW = _momentum * v.dW + grads[i].dW;
+    v.db = _momentum * v.db + grads[i].db;
+    update.dW = _lr * v.dW;
+    update.db = _lr * v.db;
+    net.layer(i).applyStep(update);
+  }
+}
+
+AdamOptimizer::AdamOptimizer(double lr, double beta1, double beta2, double eps)
+    : _lr(lr), _beta1(beta1), _beta2(beta2), _eps(eps) {
+  if (lr <= 0.0 || beta1 < 0.0 || beta1 >= 1.0 || beta2 < 0.0 ||
+      beta2 >= 1.0 || eps <= 0.0) {
+    throw std::invalid_argument("Adam 超参数非法");
+  }
+}
+
+void AdamOptimizer::step(MLPNetwork &net,
+                         const std::vector<LayerGradient> &grads) {
+  check_grads(net, grads);
+  init_state(_m, grads);
+  init_state(_v, grads);
+
+  ++_t;
+  const double bias1 = 1.0 - std::pow(_beta1, static_cast<double>(_t));
+  const double bias2 = 1.0 - std::pow(_beta2, static_cast<double>(_t));
+  const double step_size = _lr / bias1;
+  const double sqrt_bias2 = std::sqrt(bias2);
+
+  LayerGradient update;
+  for (size_t i = 0; i < grads.size(); ++i) {
+    if (grads[i].empty()) {
+      continue;
+    }
+    LayerGradient &m = _m[i];
+    LayerGradient &v = _v[i];
+    m.dW = _beta1 * m.dW + (1.0 - _beta1) * grads[i].dW;
+    m.db = _beta1 * m.db + (1.0 - _beta1) * grads[i].db;
+    v.dW = _beta2 * v.dW + (1.0 - _beta2) * grads[i].dW.cwiseAbs2();
+    v.db = _beta2 * v.db + (1.0 - _beta2) * grads[i].db.cwiseAbs2();
+
+    update.dW = step_size * m.dW.array() /
+                (v.dW.array().sqrt() / sqrt_bias2 + _eps);
+    update.db = step_size * m.db.array() /
+                (v.db.array().sqrt() / sqrt_bias2 + _eps);
+    net.layer(i).applyStep(update);
+  }
+}
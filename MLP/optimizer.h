@@ -0,0 +1,47 @@
+#pragma once
+
+#include "layer.h"
+#include "mlp_network.h"
+#include <vector>
+
+/// 优化器：根据每层的平均梯度更新网络参数
+class Optimizer {
+public:
+  virtual ~Optimizer() = default;
+  /**
+   * @brief 执行一步参数更新
+   * @param net 待更新的网络
+   * @param grads 与 net 的层一一对应的梯度，无参数的层为空
+   */
+  virtual void step(MLPNetwork &net,
+                    const std::vector<LayerGradient> &grads) = 0;
+};
+
+/// 带动量的 SGD：v = momentum * v + g, param -= lr * v
+class SGDOptimizer : public Optimizer {
+public:
+  explicit SGDOptimizer(double lr, double momentum = 0.0);
+  void step(MLPNetwork &net, const std::vector<LayerGradient> &grads) override;
+
+private:
+  double _lr;
+  double _momentum;
+  std::vector<LayerGradient> _velocity;
+};
+
+/// Adam，默认超参数与 torch.optim.Adam 一致
+class AdamOptimizer : public Optimizer {
+public:
+  explicit AdamOptimizer(double lr = 1e-3, double beta1 = 0.9,
+                         double beta2 = 0.999, double eps = 1e-8);
+  void step(MLPNetwork &net, const std::vector<LayerGradient> &grads) override;
+
+private:
+  double _lr;
+  double _beta1;
+  double _beta2;
+  double _eps;
+  long long _t = 0;
+  std::vector<LayerGradient> _m;
+  std::vector<LayerGradient> _v;
+};
@@ -0,0 +1,92 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t num_threads)
+    : ThreadPool(num_threads, nullptr) {}
+
+ThreadPool::ThreadPool(size_t num_threads,
+                       std::function<void(size_t)> on_start)
+    : _size(num_threads), _on_start(std::move(on_start)) {
+  if (_size == 0) {
+    _size = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  _threads.reserve(_size - 1);
+  for (size_t i = 1; i < _size; ++i) {
+    _threads.emplace_back(&ThreadPool::workerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _start_cv.notify_all();
+  for (auto &t : _threads) {
+    t.join();
+  }
+}
+
+void ThreadPool::run(const std::function<void(size_t)> &task) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _task = &task;
+    _pending = _size - 1;
+    _error = nullptr;
+    ++_generation;
+  }
+  _start_cv.notify_all();
+
+  std::exception_ptr local_error;
+  try {
+    task(0);
+  } catch (...) {
+    local_error = std::current_exception();
+  }
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  _done_cv.wait(lock, [this] { return _pending == 0; });
+  _task = nullptr;
+  if (local_error == nullptr) {
+    local_error = _error;
+  }
+  lock.unlock();
+
+  if (local_error != nullptr) {
+    std::rethrow_exception(local_error);
+  }
+}
+
+void ThreadPool::workerLoop(size_t id) {
+  if (_on_start) {
+    _on_start(id);
+  }
+  size_t seen = 0;
+  while (true) {
+    const std::function<void(size_t)> *task = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _start_cv.wait(lock, [&] { return _stop || _generation != seen; });
+      if (_stop) {
+        return;
+      }
+      seen = _generation;
+      task = _task;
+    }
+
+    std::exception_ptr error;
+    try {
+      (*task)(id);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (error != nullptr && _error == nullptr) {
+      _error = error;
+    }
+    if (--_pending == 0) {
+      _done_cv.notify_one();
+    }
+  }
+}
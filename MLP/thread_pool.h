@@ -0,0 +1,50 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// 固定大小的线程池，每次 run 让所有线程各执行一次任务（fork-join）
+class ThreadPool {
+public:
+  /**
+   * @param num_threads 线程数（含调用线程），0 表示使用全部硬件线程
+   */
+  explicit ThreadPool(size_t num_threads = 0);
+  /**
+   * @param on_start 每个后台线程（id 1..num_threads-1）启动时先执行一次，
+   *                 可用于绑核等线程级初始化
+   */
+  ThreadPool(size_t num_threads, std::function<void(size_t)> on_start);
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  size_t size() const { return _size; }
+
+  /**
+   * @brief 在每个线程上执行 task(worker_id)，阻塞直到全部完成
+   * 调用线程作为 worker 0 参与计算
+   * @throws 任一 worker 抛出的第一个异常
+   */
+  void run(const std::function<void(size_t)> &task);
+
+private:
+  void workerLoop(size_t id);
+
+  size_t _size = 1;
+  std::function<void(size_t)> _on_start;
+  std::vector<std::thread> _threads;
+  std::mutex _mutex;
+  std::condition_variable _start_cv;
+  std::condition_variable _done_cv;
+  const std::function<void(size_t)> *_task = nullptr;
+  size_t _generation = 0;
+  size_t _pending = 0;
+  bool _stop = false;
+  std::exception_ptr _error;
+};
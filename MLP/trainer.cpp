@@ -0,0 +1,461 @@
+#include "trainer.h"
+#include "activation_layer.h"
+#include "dense_layer.h"
+#include "loss.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+// 把 worker 的工作量 [0, total) 均分后取第 id 段
+std::pair<size_t, size_t> split_range(size_t total, size_t parts, size_t id) {
+  return {total * id / parts, total * (id + 1) / parts};
+}
+
+Eigen::MatrixXd gather_batch(const std::vector<MNISetData> &data,
+                             const size_t *indices, size_t count,
+                             std::vector<int> &labels) {
+  const Eigen::Index dim = data[indices[0]].data.size();
+  Eigen::MatrixXd X(dim, count);
+  labels.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    const MNISetData &sample = data[indices[i]];
+    if (sample.data.size() != dim) {
+      throw std::invalid_argument("样本维度不一致");
+    }
+    X.col(i) = sample.data;
+    labels[i] = sample.lab;
+  }
+  return X;
+}
+
+int count_correct(const Eigen::MatrixXd &out, const std::vector<int> &labels) {
+  int correct = 0;
+  for (Eigen::Index i = 0; i < out.cols(); ++i) {
+    Eigen::Index pred = -1;
+    out.col(i).maxCoeff(&pred);
+    if (pred == labels[i]) {
+      ++correct;
+    }
+  }
+  return correct;
+}
+} // namespace
+
+Trainer::Trainer(MLPNetwork &net, Optimizer &optimizer,
+                 const TrainConfig &config)
+    : _net(net), _optimizer(optimizer), _config(config),
+      _pool(config.num_threads), _rng(config.seed) {
+  if (_net.empty()) {
+    throw std::runtime_error("MLP NetWork empty layers");
+  }
+  if (_config.batch_size <= 0 || _config.epochs <= 0) {
+    throw std::invalid_argument("batch_size 和 epochs 必须大于0");
+  }
+  _net.checkConsistency();
+
+  _train_layers = _net.layerCount();
+  const auto *last =
+      dynamic_cast<const ActivationLayer *>(&_net.layer(_train_layers - 1));
+  if (last != nullptr &&
+      last->type() == ActivationLayer::enActiveFuncType::enSoftMax) {
+    --_train_layers;
+  }
+
+  _workers.resize(_pool.size());
+  for (auto &worker : _workers) {
+    worker.grads.resize(_net.layerCount());
+    for (size_t l = 0; l < _train_layers; ++l) {
+      _net.layer(l).initGradient(worker.grads[l]);
+    }
+  }
+}
+
+void Trainer::trainBatch(const std::vector<MNISetData> &data,
+                         const size_t *indices, size_t count) {
+  _active_workers = std::clamp<size_t>(count / kMinSamplesPerWorker, 1,
+                                       _pool.size());
+  _pool.run([&](size_t id) {
+    // 不参与本 batch 的 worker 不清零梯度，也不参与归约
+    if (id >= _active_workers) {
+      return;
+    }
+    Worker &worker = _workers[id];
+    for (auto &g : worker.grads) {
+      g.dW.setZero();
+      g.db.setZero();
+    }
+
+    auto [begin, end] = split_range(count, _active_workers, id);
+
+    std::vector<int> labels;
+    std::vector<Eigen::MatrixXd> acts(_train_layers + 1);
+    acts[0] = gather_batch(data, indices + begin, end - begin, labels);
+    for (size_t l = 0; l < _train_layers; ++l) {
+      acts[l + 1] = _net.layer(l).computeBatch(acts[l]);
+    }
+
+    Eigen::MatrixXd grad;
+    worker.loss = CrossEntropyLoss::gradient(acts.back(), labels, grad);
+    worker.correct = count_correct(acts.back(), labels);
+    for (size_t l = _train_layers; l-- > 0;) {
+      grad = _net.layer(l).backward(acts[l], acts[l + 1], grad,
+                                    worker.grads[l], l > 0);
+    }
+  });
+
+  reduceGradients(count);
+  _optimizer.step(_net, _workers[0].grads);
+}
+
+void Trainer::reduceGradients(size_t count) {
+  const double scale = 1.0 / static_cast<double>(count);
+  // 每个线程负责 dW 的一段列、db 的一段行，把参与计算的 worker 的梯度
+  // 汇总到 worker 0 并取平均
+  _pool.run([&](size_t id) {
+    LayerGradient *dst = _workers[0].grads.data();
+    for (size_t l = 0; l < _train_layers; ++l) {
+      if (dst[l].empty()) {
+        continue;
+      }
+      auto [c0, c1] = split_range(dst[l].dW.cols(), _pool.size(), id);
+      auto [r0, r1] = split_range(dst[l].db.size(), _pool.size(), id);
+      auto dW = dst[l].dW.middleCols(c0, c1 - c0);
+      auto db = dst[l].db.segment(r0, r1 - r0);
+      for (size_t w = 1; w < _active_workers; ++w) {
+        dW += _workers[w].grads[l].dW.middleCols(c0, c1 - c0);
+        db += _workers[w].grads[l].db.segment(r0, r1 - r0);
+      }
+      dW *= scale;
+      db *= scale;
+    }
+  });
+}
+
+EpochStats Trainer::trainEpoch(const std::vector<MNISetData> &data,
+                               int epoch) {
+  if (data.empty()) {
+    throw std::invalid_argument("训练集为空");
+  }
+
+  std::vector<size_t> indices(data.size());
+  std::iota(indices.begin(), indices.end(), 0);
+  std::shuffle(indices.begin(), indices.end(), _rng);
+
+  const size_t batch_size = static_cast<size_t>(_config.batch_size);
+  const size_t num_batches = (data.size() + batch_size - 1) / batch_size;
+  double total_loss = 0.0;
+  int total_correct = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t batch = 0; batch < num_batches; ++batch) {
+    const size_t begin = batch * batch_size;
+    const size_t count = std::min(batch_size, data.size() - begin);
+    trainBatch(data, indices.data() + begin, count);
+
+    double batch_loss = 0.0;
+    for (size_t w = 0; w < _active_workers; ++w) {
+      batch_loss += _workers[w].loss;
+      total_correct += _workers[w].correct;
+    }
+    total_loss += batch_loss;
+
+    if (_config.log_interval > 0 && batch % _config.log_interval == 0) {
+      std::printf("Train Epoch: %d [%zu/%zu (%.0f%%)]\tLoss: %.6f\n", epoch,
+                  begin, data.size(), 100.0 * batch / num_batches,
+                  batch_loss / count);
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  EpochStats stats;
+  stats.epoch = epoch;
+  stats.loss = total_loss / data.size();
+  stats.train_accuracy = static_cast<double>(total_correct) / data.size();
+  stats.seconds = std::chrono::duration<double>(end - start).count();
+  return stats;
+}
+
+std::vector<EpochStats> Trainer::fit(const std::vector<MNISetData> &train,
+                                     const std::vector<MNISetData> &test) {
+  std::vector<EpochStats> history;
+  for (int epoch = 1; epoch <= _config.epochs; ++epoch) {
+    EpochStats stats = trainEpoch(train, epoch);
+    if (!test.empty()) {
+      stats.test_accuracy = evaluate(test);
+    }
+    std::printf("Epoch %d: loss = %.4f, train acc = %.2f%%, test acc = "
+                "%.2f%%, time = %.2fs\n",
+                epoch, stats.loss, 100.0 * stats.train_accuracy,
+                100.0 * stats.test_accuracy, stats.seconds);
+    history.push_back(stats);
+  }
+  return history;
+}
+
+double Trainer::evaluate(const std::vector<MNISetData> &data) {
+  if (data.empty()) {
+    return 0.0;
+  }
+
+  std::vector<size_t> indices(data.size());
+  std::iota(indices.begin(), indices.end(), 0);
+
+  const size_t chunk = 256;
+  _pool.run([&](size_t id) {
+    Worker &worker = _workers[id];
+    worker.correct = 0;
+    auto [begin, end] = split_range(data.size(), _pool.size(), id);
+    std::vector<int> labels;
+    for (size_t i = begin; i < end; i += chunk) {
+      const size_t count = std::min(chunk, end - i);
+      Eigen::MatrixXd out =
+          gather_batch(data, indices.data() + i, count, labels);
+      for (size_t l = 0; l < _train_layers; ++l) {
+        out = _net.layer(l).computeBatch(out);
+      }
+      worker.correct += count_correct(out, labels);
+    }
+  });
+
+  int correct = 0;
+  for (const auto &worker : _workers) {
+    correct += worker.correct;
+  }
+  return static_cast<double>(correct) / data.size();
+}
+
+
+// --- 测试 ---
+namespace {
+// Dense(in→hidden) → ReLU → Dense(hidden→out) → Softmax
+MLPNetwork make_test_mlp(unsigned int seed, int in, int hidden, int out) {
+  std::mt19937 rng(seed);
+  MLPNetwork net;
+  auto dense1 = std::make_unique<DenseLayer>(in, hidden);
+  dense1->initRandom(rng);
+  net.addLayer(std::move(dense1));
+  net.addLayer(std::make_unique<ActivationLayer>(
+      ActivationLayer::enActiveFuncType::enReLU, hidden, hidden));
+  auto dense2 = std::make_unique<DenseLayer>(hidden, out);
+  dense2->initRandom(rng);
+  net.addLayer(std::move(dense2));
+  net.addLayer(std::make_unique<ActivationLayer>(
+      ActivationLayer::enActiveFuncType::enSoftMax, out, out));
+  return net;
+}
+
+// 前三层 + 交叉熵的总损失
+double total_loss(MLPNetwork &net, const Eigen::MatrixXd &X,
+                  const std::vector<int> &labels) {
+  Eigen::MatrixXd out = X;
+  for (size_t l = 0; l < 3; ++l) {
+    out = net.layer(l).computeBatch(out);
+  }
+  Eigen::MatrixXd grad;
+  return CrossEntropyLoss::gradient(out, labels, grad);
+}
+
+// 中心差分校验 Dense→ReLU→Dense→CE 的参数梯度与输入梯度
+void test_gradient_check() {
+  std::cout << "=== Testing backward (finite difference) ===" << std::endl;
+
+  MLPNetwork net = make_test_mlp(1, 5, 7, 3);
+  Eigen::MatrixXd X = Eigen::MatrixXd::Random(5, 4);
+  const std::vector<int> labels = {0, 2, 1, 2};
+
+  std::vector<LayerGradient> grads(net.layerCount());
+  std::vector<Eigen::MatrixXd> acts = {X};
+  for (size_t l = 0; l < 3; ++l) {
+    net.layer(l).initGradient(grads[l]);
+    acts.push_back(net.layer(l).computeBatch(acts[l]));
+  }
+  Eigen::MatrixXd grad;
+  CrossEntropyLoss::gradient(acts.back(), labels, grad);
+  for (size_t l = 3; l-- > 0;) {
+    grad = net.layer(l).backward(acts[l], acts[l + 1], grad, grads[l], true);
+  }
+
+  const double h = 1e-6;
+  double max_err = 0.0;
+  for (size_t l : {size_t(0), size_t(2)}) {
+    auto &dense = dynamic_cast<DenseLayer &>(net.layer(l));
+    for (Eigen::Index i = 0; i < dense.getW().size(); ++i) {
+      Eigen::MatrixXd W = dense.getW();
+      const double w = W.data()[i];
+      W.data()[i] = w + h;
+      dense.setW(W);
+      const double plus = total_loss(net, X, labels);
+      W.data()[i] = w - h;
+      dense.setW(W);
+      const double minus = total_loss(net, X, labels);
+      W.data()[i] = w;
+      dense.setW(W);
+      max_err = std::max(max_err, std::abs((plus - minus) / (2 * h) -
+                                           grads[l].dW.data()[i]));
+    }
+    for (Eigen::Index i = 0; i < dense.getB().size(); ++i) {
+      Eigen::VectorXd b = dense.getB();
+      const double v = b[i];
+      b[i] = v + h;
+      dense.setB(b);
+      const double plus = total_loss(net, X, labels);
+      b[i] = v - h;
+      dense.setB(b);
+      const double minus = total_loss(net, X, labels);
+      b[i] = v;
+      dense.setB(b);
+      max_err = std::max(max_err, std::abs((plus - minus) / (2 * h) -
+                                           grads[l].db[i]));
+    }
+  }
+  for (Eigen::Index i = 0; i < X.size(); ++i) {
+    Eigen::MatrixXd Xp = X;
+    Xp.data()[i] += h;
+    Eigen::MatrixXd Xm = X;
+    Xm.data()[i] -= h;
+    const double numeric =
+        (total_loss(net, Xp, labels) - total_loss(net, Xm, labels)) / (2 * h);
+    max_err = std::max(max_err, std::abs(numeric - grad.data()[i]));
+  }
+
+  std::cout << "max |numeric - analytic| = " << max_err << std::endl;
+  std::cout << "Gradient check: " << (max_err < 1e-6 ? "PASSED" : "FAILED")
+            << std::endl;
+}
+
+// 单层网络上手算两步更新，与优化器结果比较
+void test_optimizer_step() {
+  std::cout << "\n=== Testing optimizer step ===" << std::endl;
+
+  Eigen::MatrixXd W0(2, 3);
+  W0 << 0.5, -0.2, 0.1, 0.3, 0.0, -0.4;
+  Eigen::VectorXd b0(2);
+  b0 << 0.1, -0.1;
+  std::vector<LayerGradient> g1(1), g2(1);
+  g1[0].dW = Eigen::MatrixXd::Constant(2, 3, 0.2);
+  g1[0].db = Eigen::VectorXd::Constant(2, -0.5);
+  g2[0].dW = Eigen::MatrixXd::Constant(2, 3, -0.1);
+  g2[0].db = Eigen::VectorXd::Constant(2, 0.3);
+
+  auto make_net = [&] {
+    MLPNetwork net;
+    auto dense = std::make_unique<DenseLayer>(3, 2);
+    dense->setW(W0);
+    dense->setB(b0);
+    net.addLayer(std::move(dense));
+    return net;
+  };
+  auto close = [](const MLPNetwork &net, const Eigen::MatrixXd &W,
+                  const Eigen::VectorXd &b) {
+    const auto &dense = dynamic_cast<const DenseLayer &>(net.layer(0));
+    return (dense.getW() - W).cwiseAbs().maxCoeff() < 1e-12 &&
+           (dense.getB() - b).cwiseAbs().maxCoeff() < 1e-12;
+  };
+
+  // SGD(lr=0.1, momentum=0.9): v1 = g1, v2 = 0.9 * g1 + g2
+  {
+    MLPNetwork net = make_net();
+    SGDOptimizer sgd(0.1, 0.9);
+    sgd.step(net, g1);
+    sgd.step(net, g2);
+    const Eigen::MatrixXd W =
+        W0 - 0.1 * g1[0].dW - 0.1 * (0.9 * g1[0].dW + g2[0].dW);
+    const Eigen::VectorXd b =
+        b0 - 0.1 * g1[0].db - 0.1 * (0.9 * g1[0].db + g2[0].db);
+    std::cout << "SGD momentum two steps: "
+              << (close(net, W, b) ? "PASSED" : "FAILED") << std::endl;
+  }
+
+  // Adam：按 torch.optim.Adam 的公式逐元素计算
+  {
+    MLPNetwork net = make_net();
+    AdamOptimizer adam(0.01, 0.9, 0.999, 1e-8);
+    adam.step(net, g1);
+    adam.step(net, g2);
+
+    auto adam_ref = [](double p, double a, double c) {
+      double m = 0.0, v = 0.0;
+      const double grads[] = {a, c};
+      for (int t = 1; t <= 2; ++t) {
+        const double g = grads[t - 1];
+        m = 0.9 * m + 0.1 * g;
+        v = 0.999 * v + 0.001 * g * g;
+        const double m_hat = m / (1.0 - std::pow(0.9, t));
+        const double v_hat = v / (1.0 - std::pow(0.999, t));
+        p -= 0.01 * m_hat / (std::sqrt(v_hat) + 1e-8);
+      }
+      return p;
+    };
+    Eigen::MatrixXd W = W0;
+    Eigen::VectorXd b = b0;
+    for (Eigen::Index i = 0; i < W.size(); ++i) {
+      W.data()[i] =
+          adam_ref(W0.data()[i], g1[0].dW.data()[i], g2[0].dW.data()[i]);
+    }
+    for (Eigen::Index i = 0; i < b.size(); ++i) {
+      b[i] = adam_ref(b0[i], g1[0].db[i], g2[0].db[i]);
+    }
+    std::cout << "Adam two steps: " << (close(net, W, b) ? "PASSED" : "FAILED")
+              << std::endl;
+  }
+}
+
+// 不同线程数训练一个 epoch，损失与参数应一致（只差浮点求和顺序）
+void test_thread_consistency() {
+  std::cout << "\n=== Testing multi-threaded training ===" << std::endl;
+
+  std::mt19937 rng(3);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  const Eigen::MatrixXd centers = Eigen::MatrixXd::Random(20, 4) * 3.0;
+  std::vector<MNISetData> data;
+  for (int i = 0; i < 2000; ++i) {
+    MNISetData sample;
+    sample.lab = i % 4;
+    sample.data = centers.col(sample.lab);
+    for (Eigen::Index j = 0; j < sample.data.size(); ++j) {
+      sample.data[j] += noise(rng);
+    }
+    data.push_back(sample);
+  }
+
+  std::vector<double> losses;
+  std::vector<Eigen::MatrixXd> weights;
+  for (size_t threads : {1, 3, 8}) {
+    MLPNetwork net = make_test_mlp(7, 20, 32, 4);
+    AdamOptimizer adam;
+    TrainConfig config;
+    config.epochs = 1;
+    config.num_threads = threads;
+    config.log_interval = 0;
+    Trainer trainer(net, adam, config);
+    losses.push_back(trainer.trainEpoch(data, 1).loss);
+    weights.push_back(dynamic_cast<const DenseLayer &>(net.layer(0)).getW());
+    std::cout << threads << " thread(s): loss = " << losses.back()
+              << std::endl;
+  }
+
+  bool same = true;
+  for (size_t i = 1; i < losses.size(); ++i) {
+    same = same && std::abs(losses[i] - losses[0]) < 1e-9 &&
+           (weights[i] - weights[0]).cwiseAbs().maxCoeff() < 1e-9;
+  }
+  std::cout << "1 vs N threads: " << (same ? "PASSED" : "FAILED")
+            << std::endl;
+}
+} // namespace
+
+void Trainer::test() {
+  std::cout << "Testing Trainer" << std::endl;
+  std::cout << "===============" << std::endl;
+
+  test_gradient_check();
+  test_optimizer_step();
+  test_thread_consistency();
+
+  std::cout << "\n=== Testing Complete ===" << std::endl;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "dataset.h"
+#include "layer.h"
+#include "mlp_network.h"
+#include "optimizer.h"
+#include "thread_pool.h"
+#include <random>
+#include <vector>
+
+struct TrainConfig {
+  int epochs = 5;
+  int batch_size = 64;
+  size_t num_threads = 0; // 0 表示使用全部硬件线程
+  unsigned int seed = 42;
+  int log_interval = 100; // 每隔多少个 batch 打印一次 loss，0 表示不打印
+};
+
+struct EpochStats {
+  int epoch = 0;
+  double loss = 0.0;           // 训练集平均损失
+  double train_accuracy = 0.0; // 训练过程中的准确率
+  double test_accuracy = 0.0;  // 测试集准确率，无测试集时为 0
+  double seconds = 0.0;        // 训练耗时（不含测试）
+};
+
+/**
+ * @brief 小批量训练：交叉熵损失 + 反向传播 + 优化器更新
+ *
+ * 每个 batch 按列切分给线程池中的各线程，各线程独立前向/反向并累加
+ * 自己的梯度，最后并行归约为平均梯度交给优化器。
+ * 若网络以 Softmax 结尾，训练时跳过该层，直接对其输入计算交叉熵
+ * （等价于 PyTorch 中 logits + nn.CrossEntropyLoss）。
+ */
+class Trainer {
+public:
+  Trainer(MLPNetwork &net, Optimizer &optimizer,
+          const TrainConfig &config = TrainConfig());
+
+  /// 训练一个 epoch
+  EpochStats trainEpoch(const std::vector<MNISetData> &data, int epoch);
+  /// 按 config.epochs 训练，每个 epoch 结束后在 test 上评估
+  std::vector<EpochStats> fit(const std::vector<MNISetData> &train,
+                              const std::vector<MNISetData> &test);
+  /// 返回分类准确率
+  double evaluate(const std::vector<MNISetData> &data);
+
+  /// 梯度数值校验、优化器单步校验、多线程一致性测试
+  static void test();
+
+private:
+  struct Worker {
+    std::vector<LayerGradient> grads;
+    double loss = 0.0;
+    int correct = 0;
+  };
+
+  void trainBatch(const std::vector<MNISetData> &data, const size_t *indices,
+                  size_t count);
+  void reduceGradients(size_t count);
+
+  // 每个参与计算的 worker 至少分到的样本数。每个 worker 都要清零、归约一整份
+  // 梯度，样本太少时这部分内存开销会超过并行带来的收益
+  static constexpr size_t kMinSamplesPerWorker = 8;
+
+  MLPNetwork &_net;
+  Optimizer &_optimizer;
+  TrainConfig _config;
+  ThreadPool _pool;
+  std::mt19937 _rng;
+  size_t _train_layers = 0; // 参与训练的层数（不含末尾的 Softmax）
+  std::vector<Worker> _workers;
+  size_t _active_workers = 0; // 当前 batch 实际参与计算的 worker 数
+};